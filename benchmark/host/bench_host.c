@@ -0,0 +1,110 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: bench_host.c
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: PC
+* Notes                 :   Plataforma PC de la suite. El tiempo es de CPU del driver
+*                           (no hay bus real); bytes, transacciones, reservas y pila
+*                           se miden igual que en el ESP32.
+*
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "Driver_oled.h"
+#include "oled_bench.h"
+
+// Pila del hilo de cada escenario, en bytes
+#define BENCH_PILA		(256 * 1024)
+// Patrón para pintar la pila y ver hasta dónde se usó
+#define BENCH_PINTURA	0xA5
+
+const char *bench_plataforma = "host";
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+
+void *__wrap_malloc(size_t size){
+    if (bench_contando) {
+        bench_bus.allocs++;
+    }
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size){
+    if (bench_contando) {
+        bench_bus.allocs++;
+    }
+    return __real_calloc(n, size);
+}
+
+
+
+int64_t bench_tiempo_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+
+
+// Datos para el hilo de un escenario
+typedef struct {
+	void (*fn)(void *);
+	void *arg;
+} bench_hilo_t;
+
+static void *bench_hilo(void *arg){
+    bench_hilo_t *h = arg;
+    h->fn(h->arg);
+    return NULL;
+}
+
+
+
+/***************************************************************************
+* Function: bench_correr_con_pila
+* Preconditions: Ninguna.
+* Overview: Ejecuta fn(arg) en un hilo con una pila propia pintada con un patrón.
+*           La pila crece hacia abajo, lo que sigue pintado desde el inicio del
+*           buffer nunca se usó.
+* Input: void (*fn)(void *), void *arg
+* Output: uint32_t (bytes de pila usados)
+*****************************************************************************/
+uint32_t bench_correr_con_pila(void (*fn)(void *), void *arg){
+    bench_hilo_t h = { fn, arg };
+    pthread_attr_t attr;
+    pthread_t hilo;
+    uint8_t *pila = __real_malloc(BENCH_PILA);
+    size_t libre = 0;
+
+    if (pila == NULL) {
+        return 0;
+    }
+    memset(pila, BENCH_PINTURA, BENCH_PILA);
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, pila, BENCH_PILA);
+    if (pthread_create(&hilo, &attr, bench_hilo, &h) == 0) {
+        pthread_join(hilo, NULL);
+    }
+    pthread_attr_destroy(&attr);
+
+    while (libre < BENCH_PILA && pila[libre] == BENCH_PINTURA) {
+        libre++;
+    }
+    free(pila);
+    return BENCH_PILA - libre;
+}
+
+
+
+int main(void){
+    i2c_init(I2C_NUM_0, GPIO_NUM_21, GPIO_NUM_22, 0x3C);
+    oled_bench_correr();
+    return 0;
+}
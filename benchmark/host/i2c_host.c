@@ -0,0 +1,101 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: i2c_host.c
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: PC
+* Notes                 :   Sustituto en PC del driver I2C. Igual que el driver de
+*                           ESP-IDF v4.4 con enlace dinámico, reserva memoria para el
+*                           enlace y para cada comando agregado, así las reservas que
+*                           se cuentan en PC se parecen a las del ESP32. No hay bus:
+*                           al ejecutar la secuencia solo se cuentan bytes y transacciones.
+*
+*******************************************************************************/
+#include <stdlib.h>
+#include "driver/i2c.h"
+#include "oled_bench.h"
+
+// Un comando de la secuencia
+typedef struct i2c_host_cmd {
+	struct i2c_host_cmd *sig;
+	size_t bytes;				// Bytes que pone en el bus (0 para start y stop)
+} i2c_host_cmd_t;
+
+// Enlace de comandos
+typedef struct {
+	i2c_host_cmd_t *primero;
+	i2c_host_cmd_t *ultimo;
+} i2c_host_link_t;
+
+
+
+static esp_err_t i2c_host_agregar(i2c_cmd_handle_t cmd_handle, size_t bytes){
+    i2c_host_link_t *link = cmd_handle;
+    i2c_host_cmd_t *cmd = calloc(1, sizeof(i2c_host_cmd_t));
+
+    if (cmd == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    cmd->bytes = bytes;
+    if (link->ultimo) {
+        link->ultimo->sig = cmd;
+    } else {
+        link->primero = cmd;
+    }
+    link->ultimo = cmd;
+    return ESP_OK;
+}
+
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t *i2c_conf){
+    return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags){
+    return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void){
+    return calloc(1, sizeof(i2c_host_link_t));
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle){
+    i2c_host_link_t *link = cmd_handle;
+    i2c_host_cmd_t *cmd = link->primero;
+
+    while (cmd) {
+        i2c_host_cmd_t *sig = cmd->sig;
+        free(cmd);
+        cmd = sig;
+    }
+    free(link);
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle){
+    return i2c_host_agregar(cmd_handle, 0);
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en){
+    return i2c_host_agregar(cmd_handle, 1);
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en){
+    return i2c_host_agregar(cmd_handle, data_len);
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle){
+    return i2c_host_agregar(cmd_handle, 0);
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait){
+    i2c_host_link_t *link = cmd_handle;
+
+    if (bench_contando) {
+        for (i2c_host_cmd_t *cmd = link->primero; cmd; cmd = cmd->sig) {
+            bench_bus.bytes += cmd->bytes;
+        }
+        bench_bus.transacciones++;
+    }
+    return ESP_OK;
+}
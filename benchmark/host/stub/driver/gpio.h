@@ -0,0 +1,12 @@
+// Sustituto en PC de driver/gpio.h de ESP-IDF
+#pragma once
+
+typedef enum {
+	GPIO_NUM_21 = 21,
+	GPIO_NUM_22 = 22,
+} gpio_num_t;
+
+typedef enum {
+	GPIO_PULLUP_DISABLE = 0,
+	GPIO_PULLUP_ENABLE = 1,
+} gpio_pullup_t;
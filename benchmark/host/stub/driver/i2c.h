@@ -0,0 +1,35 @@
+// Sustituto en PC del driver I2C de ESP-IDF (API heredada de la v4.4).
+// La implementación está en i2c_host.c y cuenta bytes y transacciones.
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "hal/i2c_types.h"
+#include "freertos/portmacro.h"
+
+typedef void *i2c_cmd_handle_t;
+
+typedef struct {
+	i2c_mode_t mode;
+	int sda_io_num;
+	bool sda_pullup_en;
+	int scl_io_num;
+	bool scl_pullup_en;
+	union {
+		struct {
+			uint32_t clk_speed;
+		} master;
+	};
+} i2c_config_t;
+
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t *i2c_conf);
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags);
+i2c_cmd_handle_t i2c_cmd_link_create(void);
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait);
@@ -0,0 +1,7 @@
+// Sustituto en PC de esp_log.h de ESP-IDF
+#pragma once
+#include <stdio.h>
+
+#define ESP_LOGE(tag, fmt, ...)	fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)	fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...)	fprintf(stderr, "I %s: " fmt "\n", tag, ##__VA_ARGS__)
@@ -0,0 +1,7 @@
+// Sustituto en PC de freertos/portmacro.h (tick de 10 ms como sdkconfig)
+#pragma once
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+
+#define portTICK_PERIOD_MS	10
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: bench_esp32.c
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: I2C, OLED 128x64
+* Notes                 :   Plataforma ESP32 de la suite. Los contadores se toman
+*                           envolviendo con el linker (-Wl,--wrap, ver CMakeLists.txt)
+*                           las funciones del driver I2C y las de memoria dinámica,
+*                           así se mide el driver real sin modificarlo.
+*
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "Driver_oled.h"
+#include "oled_bench.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+// Pila de la tarea de cada escenario, en bytes
+#define BENCH_PILA	4096
+
+const char *bench_plataforma = "esp32";
+
+// Funciones originales
+esp_err_t __real_i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en);
+esp_err_t __real_i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en);
+esp_err_t __real_i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait);
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_heap_caps_malloc(size_t size, uint32_t caps);
+void *__real_heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+
+
+
+/***************************************************************************
+* Envolturas del driver I2C y de la memoria dinámica
+*****************************************************************************/
+esp_err_t __wrap_i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en){
+    if (bench_contando) {
+        bench_bus.bytes++;
+    }
+    return __real_i2c_master_write_byte(cmd_handle, data, ack_en);
+}
+
+esp_err_t __wrap_i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en){
+    if (bench_contando) {
+        bench_bus.bytes += data_len;
+    }
+    return __real_i2c_master_write(cmd_handle, data, data_len, ack_en);
+}
+
+esp_err_t __wrap_i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait){
+    if (bench_contando) {
+        bench_bus.transacciones++;
+    }
+    return __real_i2c_master_cmd_begin(i2c_num, cmd_handle, ticks_to_wait);
+}
+
+void *__wrap_malloc(size_t size){
+    if (bench_contando) {
+        bench_bus.allocs++;
+    }
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size){
+    if (bench_contando) {
+        bench_bus.allocs++;
+    }
+    return __real_calloc(n, size);
+}
+
+void *__wrap_heap_caps_malloc(size_t size, uint32_t caps){
+    if (bench_contando) {
+        bench_bus.allocs++;
+    }
+    return __real_heap_caps_malloc(size, caps);
+}
+
+void *__wrap_heap_caps_calloc(size_t n, size_t size, uint32_t caps){
+    if (bench_contando) {
+        bench_bus.allocs++;
+    }
+    return __real_heap_caps_calloc(n, size, caps);
+}
+
+
+
+/***************************************************************************
+* Function: bench_tiempo_us
+* Preconditions: Ninguna.
+* Overview: Tiempo desde el arranque en microsegundos.
+* Input: Ninguno
+* Output: int64_t
+*****************************************************************************/
+int64_t bench_tiempo_us(void){
+    return esp_timer_get_time();
+}
+
+
+
+// Datos para la tarea de un escenario
+typedef struct {
+	void (*fn)(void *);
+	void *arg;
+	TaskHandle_t padre;
+	uint32_t libre;
+} bench_tarea_t;
+
+static void bench_tarea(void *arg){
+    bench_tarea_t *t = arg;
+
+    t->fn(t->arg);
+    t->libre = uxTaskGetStackHighWaterMark(NULL); // En ESP-IDF la pila se mide en bytes
+    xTaskNotifyGive(t->padre);
+    vTaskDelete(NULL);
+}
+
+
+
+/***************************************************************************
+* Function: bench_correr_con_pila
+* Preconditions: Ninguna.
+* Overview: Ejecuta fn(arg) en una tarea nueva de BENCH_PILA bytes y espera a que
+*           termine. Lo que nunca se tocó de la pila es la marca de agua.
+* Input: void (*fn)(void *), void *arg
+* Output: uint32_t (bytes de pila usados)
+*****************************************************************************/
+uint32_t bench_correr_con_pila(void (*fn)(void *), void *arg){
+    bench_tarea_t t = { fn, arg, xTaskGetCurrentTaskHandle(), 0 };
+
+    if (xTaskCreate(bench_tarea, "oled_bench", BENCH_PILA, &t, uxTaskPriorityGet(NULL), NULL) != pdPASS) {
+        printf("No hay memoria para la tarea del escenario\n");
+        return 0;
+    }
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return BENCH_PILA - t.libre;
+}
+
+
+
+void app_main(void)
+{
+    i2c_init(I2C_NUM_0, GPIO_NUM_21, GPIO_NUM_22, 0x3C); // Se conecta el display con i2c
+    oled_bench_correr();
+}
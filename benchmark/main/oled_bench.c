@@ -0,0 +1,176 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: oled_bench.c
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: I2C, OLED 128x64
+* Notes                 :   Escenarios fijos de la suite. Cada escenario corre en su
+*                           propia pila y se reporta como una línea JSON:
+*   {"oled_bench":1,"plataforma":"host","escenario":"glifo","iter":100,
+*    "us_op":1.2,"bytes_op":21.0,"tx_op":4.0,"allocs_op":0.0,"pila_bytes":96}
+*                           Los valores _op son por iteración; pila_bytes ya tiene
+*                           restado lo que usa una función vacía.
+*
+*******************************************************************************/
+#include <stdio.h>
+#include "Driver_oled.h"
+#include "oled_bench.h"
+
+volatile bench_contadores_t bench_bus;
+volatile bool bench_contando = false;
+
+// Estructura de un escenario
+typedef struct {
+	const char *nombre;
+	void (*preparar)(void);		// Fuera de la medición, puede ser NULL
+	void (*ejecutar)(void);		// Una iteración
+	uint32_t iteraciones;
+} bench_escenario_t;
+
+// Resultado de correr un escenario en su pila
+typedef struct {
+	const bench_escenario_t *escenario;
+	int64_t us;
+	bench_contadores_t contadores;
+} bench_medicion_t;
+
+static uint8_t bench_fb[OLED_FB_BYTES];
+static i2c_oled_campo_t bench_campo;
+static int32_t bench_valor;
+static char bench_linea[] = "0123456789ABCDEF";
+static char bench_texto[] = "DRIVER OLED";
+
+static const uint8_t bench_menu[] = {
+	OLED_DL_CABECERA,
+	OLED_DL_LIMPIAR(0x00),
+	OLED_DL_TEXTO_N(0, 0, 4), 'M', 'e', 'n', 'u',
+	OLED_DL_RELLENO(1, 0, 128, 0x01),
+	OLED_DL_TEXTO(2, 8, 6), 'B', 'r', 'i', 'l', 'l', 'o',
+	OLED_DL_TEXTO(3, 8, 6), 'R', 'e', 'l', 'o', 'j', ' ',
+	OLED_DL_TEXTO(4, 8, 6), 'S', 'a', 'l', 'i', 'r', ' ',
+	OLED_DL_FIN
+};
+
+
+
+/***************************************************************************
+* Escenarios
+*****************************************************************************/
+static void esc_init(void){
+    i2c_oled_init();
+}
+
+static void esc_limpiar(void){
+    i2c_oled_reset();
+}
+
+static void esc_flush(void){
+    i2c_oled_flush(bench_fb);
+}
+
+static void esc_texto(void){
+    for (uint8_t y = 0; y < Alto / 8; y++) {
+        i2c_oled_string(bench_linea, y, 0);
+    }
+}
+
+static void esc_glifo(void){
+    i2c_oled_pos(0, 0);
+    i2c_oled_char('A');
+}
+
+static void esc_banner(void){
+    i2c_oled_banner_N(bench_texto);
+}
+
+static void esc_icono(void){
+    i2c_oled_pila(7, 100);
+    i2c_oled_wifi(7, 0);
+}
+
+static void esc_campo_preparar(void){
+    bench_valor = 0;
+    i2c_oled_campo_init(&bench_campo, 2, 0, 7, 1, OLED_CAMPO_DERECHA, " rpm", false);
+    i2c_oled_campo_valor(&bench_campo, bench_valor);
+}
+
+static void esc_campo(void){
+    i2c_oled_campo_valor(&bench_campo, ++bench_valor);
+}
+
+static void esc_lista(void){
+    i2c_oled_lista_bus(bench_menu, sizeof(bench_menu));
+}
+
+static void esc_vacio(void){
+}
+
+static const bench_escenario_t escenarios[] = {
+	{ "init",		NULL,				esc_init,		10 },
+	{ "limpiar",	NULL,				esc_limpiar,	3 },
+	{ "flush",		NULL,				esc_flush,		10 },
+	{ "texto",		NULL,				esc_texto,		3 },
+	{ "glifo",		NULL,				esc_glifo,		100 },
+	{ "banner",		NULL,				esc_banner,		1 },
+	{ "icono",		NULL,				esc_icono,		10 },
+	{ "campo",		esc_campo_preparar,	esc_campo,		100 },
+	{ "lista",		NULL,				esc_lista,		10 },
+};
+
+
+
+/***************************************************************************
+* Function: bench_medir
+* Preconditions: bench_correr_con_pila
+* Overview: Corre las iteraciones de un escenario con los contadores en cero.
+*           Se ejecuta dentro de la pila nueva.
+* Input: void *arg (bench_medicion_t)
+* Output: Ninguno
+*****************************************************************************/
+static void bench_medir(void *arg){
+    bench_medicion_t *m = arg;
+    const bench_escenario_t *e = m->escenario;
+
+    memset((void *)&bench_bus, 0, sizeof(bench_bus));
+    bench_contando = true;
+    int64_t t0 = bench_tiempo_us();
+    for (uint32_t i = 0; i < e->iteraciones; i++) {
+        e->ejecutar();
+    }
+    m->us = bench_tiempo_us() - t0;
+    bench_contando = false;
+    m->contadores = bench_bus;
+}
+
+
+
+/***************************************************************************
+* Function: oled_bench_correr
+* Preconditions: i2c_init
+* Overview: Corre todos los escenarios en orden y reporta cada uno en JSON.
+* Input: Ninguno
+* Output: Ninguno
+*****************************************************************************/
+void oled_bench_correr(void){
+    const bench_escenario_t vacio = { "vacio", NULL, esc_vacio, 1 };
+    bench_medicion_t m = { .escenario = &vacio };
+    uint32_t pila_base = bench_correr_con_pila(bench_medir, &m);
+
+    for (size_t k = 0; k < sizeof(escenarios) / sizeof(escenarios[0]); k++) {
+        const bench_escenario_t *e = &escenarios[k];
+        if (e->preparar) {
+            e->preparar();
+        }
+        m.escenario = e;
+        uint32_t pila = bench_correr_con_pila(bench_medir, &m);
+        float n = e->iteraciones;
+
+        printf("{\"oled_bench\":1,\"plataforma\":\"%s\",\"escenario\":\"%s\",\"iter\":%u,"
+               "\"us_op\":%.1f,\"bytes_op\":%.1f,\"tx_op\":%.1f,\"allocs_op\":%.1f,\"pila_bytes\":%u}\n",
+               bench_plataforma, e->nombre, (unsigned)e->iteraciones,
+               m.us / n, m.contadores.bytes / n, m.contadores.transacciones / n, m.contadores.allocs / n,
+               (unsigned)(pila > pila_base ? pila - pila_base : 0));
+    }
+}
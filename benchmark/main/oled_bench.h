@@ -0,0 +1,42 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: oled_bench.h
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: I2C, OLED 128x64
+* Notes                 :   Suite de rendimiento del driver. Los escenarios son los
+*                           mismos en el ESP32 y en la PC; cada plataforma da el
+*                           reloj, la pila nueva por escenario y los contadores.
+*
+*******************************************************************************/
+#ifndef OLED_BENCH_H
+#define OLED_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Contadores que la plataforma incrementa mientras bench_contando es true
+typedef struct {
+	uint32_t bytes;			// Bytes en el bus (dirección, control y datos)
+	uint32_t transacciones;	// Secuencias start..stop ejecutadas
+	uint32_t allocs;		// Reservas de memoria dinámica
+} bench_contadores_t;
+
+extern volatile bench_contadores_t bench_bus;
+extern volatile bool bench_contando;
+
+// Nombre de la plataforma para el reporte ("esp32" o "host")
+extern const char *bench_plataforma;
+
+// Función que da el tiempo en microsegundos
+int64_t bench_tiempo_us(void);
+
+// Función que ejecuta fn(arg) en una pila nueva y regresa los bytes de pila usados
+uint32_t bench_correr_con_pila(void (*fn)(void *), void *arg);
+
+// Función que corre todos los escenarios e imprime una línea JSON por escenario
+void oled_bench_correr(void);
+
+#endif
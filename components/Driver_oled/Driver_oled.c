@@ -188,6 +188,77 @@ void i2c_oled_dato(uint8_t data){
 
 
 
+/**************************************************************************
+* Function: i2c_oled_cmd_n
+* Preconditions: La estructura i2c_oled_t debe estar definida previamente y la conexión I2C inicializada.
+* Overview: Envía varios bytes de comando al dispositivo OLED en una sola transacción I2C.
+* Input:
+*   - const uint8_t *dato: Los bytes de comando a enviar.
+*   - size_t len: Cantidad de bytes.
+* Output: Ninguno.
+*****************************************************************************/
+void i2c_oled_cmd_n(const uint8_t *dato, size_t len){
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create(); // Crea un nuevo objeto cmd
+    i2c_master_start(cmd); // Agrega un comando de inicio a la secuencia
+
+    i2c_master_write_byte(cmd, (oled.address << 1) | I2C_MASTER_WRITE, true); // Se conecta con el display
+    i2c_master_write_byte(cmd, 0x00, true); // Envía comando de control
+    i2c_master_write(cmd, dato, len, true); // Envía todos los comandos seguidos
+
+    i2c_master_stop(cmd); // Agrega comando de paro a la secuencia
+    i2c_master_cmd_begin(oled.i2c_port, cmd, 500/portTICK_PERIOD_MS); // Envía la secuencia de comandos construida
+    i2c_cmd_link_delete(cmd); // Elimina el objeto cmd
+}
+
+
+
+/**************************************************************************
+* Function: i2c_oled_datos
+* Preconditions: La estructura i2c_oled_t debe estar definida previamente y la conexión I2C inicializada.
+* Overview: Envía un bloque de datos al dispositivo OLED en una sola transacción I2C.
+*           A diferencia de llamar i2c_oled_dato por cada byte, solo se paga una vez
+*           el inicio, la dirección y el byte de control.
+* Input:
+*   - const uint8_t *data: Los bytes de datos a enviar.
+*   - size_t len: Cantidad de bytes.
+* Output: Ninguno.
+*****************************************************************************/
+void i2c_oled_datos(const uint8_t *data, size_t len){
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create(); // Crea un nuevo objeto cmd
+    i2c_master_start(cmd); // Agrega un comando de inicio a la secuencia
+
+    i2c_master_write_byte(cmd, (oled.address << 1) | I2C_MASTER_WRITE, true); // Se conecta con el display
+    i2c_master_write_byte(cmd, 0x40, true); // Envía comando de datos
+    i2c_master_write(cmd, data, len, true); // Envía el bloque completo
+
+    i2c_master_stop(cmd); // Agrega comando de paro a la secuencia
+    i2c_master_cmd_begin(oled.i2c_port, cmd, 500/portTICK_PERIOD_MS); // Envía la secuencia de comandos construida
+    i2c_cmd_link_delete(cmd); // Elimina el objeto cmd
+}
+
+
+
+/**************************************************************************
+* Function: i2c_oled_flush
+* Preconditions: i2c_oled_cmd_n, i2c_oled_datos
+* Overview: Manda un framebuffer completo al display. El framebuffer está en el
+*           formato de páginas del controlador: OLED_FB_BYTES bytes, una página de
+*           Ancho bytes tras otra y cada byte es una columna de 8 píxeles (bit 0 arriba).
+*           Se usan dos transacciones por página (posición y datos).
+* Input:
+*   - const uint8_t *fb: Framebuffer de OLED_FB_BYTES bytes.
+* Output: Ninguno.
+*****************************************************************************/
+void i2c_oled_flush(const uint8_t *fb){
+    for (uint8_t pagina = 0; pagina < Alto / 8; pagina++) {
+        uint8_t pos[] = { 0x00, 0x10, 0xB0 + pagina }; // Columna 0 de la página
+        i2c_oled_cmd_n(pos, sizeof(pos));
+        i2c_oled_datos(fb + pagina * Ancho, Ancho);
+    }
+}
+
+
+
 /**************************************************************************
 * Function: i2c_oled_pos
 * Preconditions: La estructura i2c_oled_t debe estar definida previamente y la conexión I2C inicializada.
@@ -268,6 +339,31 @@ void i2c_oled_char(uint8_t caracter){
 
 
 
+/***************************************************************************
+* Function: i2c_oled_glifo
+* Preconditions: Ninguna.
+* Overview: Rasteriza un carácter a 8 columnas (bit 0 arriba) con la misma
+*           orientación que i2c_oled_char_n, sin mandarlo al display.
+* Input: uint8_t caracter (carácter), bool negado (invierte los píxeles), uint8_t *col (8 columnas)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_glifo(uint8_t caracter, bool negado, uint8_t *col){
+    if (caracter < 32 || caracter > 126) {
+        caracter = ' ';
+    }
+    const uint8_t *filas = caracteres[caracter - 32];
+
+    for (int i = 0; i < 8; i++) {
+        uint8_t columna = 0;
+        for (int j = 0; j < 8; j++) {
+            columna |= ((filas[j] >> i) & 0x01) << j;
+        }
+        col[i] = negado ? ~columna : columna;
+    }
+}
+
+
+
 /***************************************************************************
 * Function: i2c_oled_string
 * Preconditions: i2c_oled_pos, i2c_oled_char
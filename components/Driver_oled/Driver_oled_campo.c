@@ -0,0 +1,194 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: Driver_oled_campo.c
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: I2C, OLED 128x64
+* Notes                 :   Campos numéricos que se actualizan en su lugar. Se guarda
+*                           el texto que está en pantalla y en cada actualización solo
+*                           se rasterizan los caracteres que cambiaron y solo se mandan
+*                           las columnas que son distintas.
+*
+*******************************************************************************/
+#include <stdio.h>
+#include "Driver_oled.h"
+
+// Huecos de hasta estas columnas iguales se mandan en la misma transacción,
+// porque reposicionar cuesta más bytes (dirección, control y 3 comandos).
+// Debe ser menor a 8 para que el hueco nunca cubra un carácter sin rasterizar.
+#define CAMPO_HUECO		6
+
+
+
+/***************************************************************************
+* Function: campo_formatear
+* Preconditions: Ninguna.
+* Overview: Convierte un valor en punto fijo a texto sin usar sprintf, alineado
+*           dentro de 'ancho' caracteres. Si no cabe se llena con '#'.
+* Input: const i2c_oled_campo_t *campo, int32_t valor, char *texto (ancho caracteres)
+* Output: Ninguno
+*****************************************************************************/
+static void campo_formatear(const i2c_oled_campo_t *campo, int32_t valor, char *texto){
+    char tmp[12]; // Dígitos al revés: 10 dígitos, punto y signo
+    uint8_t n = 0;
+    uint32_t v = valor < 0 ? -(uint32_t)valor : (uint32_t)valor;
+
+    for (uint8_t d = 0; d < campo->decimales; d++) {
+        tmp[n++] = '0' + v % 10;
+        v /= 10;
+    }
+    if (campo->decimales) {
+        tmp[n++] = '.';
+    }
+    do {
+        tmp[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    if (valor < 0) {
+        tmp[n++] = '-';
+    }
+
+    if (n > campo->ancho) {
+        memset(texto, '#', campo->ancho);
+        return;
+    }
+
+    uint8_t relleno = campo->ancho - n;
+    uint8_t k = 0;
+    if (campo->alineacion == OLED_CAMPO_DERECHA) {
+        while (k < relleno) {
+            texto[k++] = ' ';
+        }
+    }
+    while (n) {
+        texto[k++] = tmp[--n];
+    }
+    while (k < campo->ancho) {
+        texto[k++] = ' ';
+    }
+}
+
+
+
+/***************************************************************************
+* Function: campo_enviar
+* Preconditions: i2c_oled_cmd_n, i2c_oled_datos
+* Overview: Manda un tramo de columnas del campo con una posición y un bloque de datos.
+* Input: const i2c_oled_campo_t *campo, const uint8_t *columnas, int inicio, int fin (inclusive)
+* Output: Ninguno
+*****************************************************************************/
+static void campo_enviar(const i2c_oled_campo_t *campo, const uint8_t *columnas, int inicio, int fin){
+    uint8_t x = campo->x + inicio;
+    uint8_t pos[] = { 0x00 + (0x0F & x), 0x10 + (0x0F & (x >> 4)), 0xB0 + campo->y };
+
+    i2c_oled_cmd_n(pos, sizeof(pos));
+    i2c_oled_datos(columnas + inicio, fin - inicio + 1);
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_campo_init
+* Preconditions: Ninguna.
+* Overview: Configura un campo numérico. No dibuja nada; el primer
+*           i2c_oled_campo_valor dibuja el campo completo con sus unidades.
+* Input: i2c_oled_campo_t *campo, uint8_t y (página), uint8_t x (columna),
+*        uint8_t ancho (caracteres del número incluyendo signo y punto),
+*        uint8_t decimales (el valor se da multiplicado por 10^decimales),
+*        i2c_oled_alineacion_t alineacion, const char *unidades (sufijo o NULL),
+*        bool negado (píxeles invertidos como i2c_oled_string_N)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_campo_init(i2c_oled_campo_t *campo, uint8_t y, uint8_t x, uint8_t ancho, uint8_t decimales,
+                         i2c_oled_alineacion_t alineacion, const char *unidades, bool negado){
+    uint8_t caben;
+
+    memset(campo, 0, sizeof(*campo));
+    campo->y = y > 7 ? 7 : y;
+    campo->x = x > Ancho - 8 ? Ancho - 8 : x;
+    caben = (Ancho - campo->x) / 8; // Caracteres que caben hasta el borde
+    if (caben > OLED_CAMPO_MAX) {
+        caben = OLED_CAMPO_MAX;
+    }
+    campo->ancho = ancho > caben ? caben : ancho;
+    campo->decimales = decimales > 9 ? 9 : decimales;
+    campo->alineacion = alineacion;
+    campo->negado = negado;
+
+    // Las unidades van fijas después del número
+    campo->largo = campo->ancho;
+    while (unidades && unidades[campo->largo - campo->ancho] && campo->largo < caben) {
+        campo->texto[campo->largo] = unidades[campo->largo - campo->ancho];
+        campo->largo++;
+    }
+    campo->valido = false;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_campo_invalidar
+* Preconditions: i2c_oled_campo_init
+* Overview: Olvida lo que está en pantalla para que la siguiente actualización
+*           redibuje el campo completo (por ejemplo después de i2c_oled_reset).
+* Input: i2c_oled_campo_t *campo
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_campo_invalidar(i2c_oled_campo_t *campo){
+    campo->valido = false;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_campo_valor
+* Preconditions: i2c_oled_campo_init, i2c_init, i2c_oled_init
+* Overview: Muestra un valor en el campo. Compara el texto nuevo con el que está
+*           en pantalla, rasteriza solo los caracteres distintos y manda solo las
+*           columnas que cambiaron. Si nada cambió no se usa el bus.
+* Input: i2c_oled_campo_t *campo, int32_t valor (en punto fijo, 1234 con 2 decimales es 12.34)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_campo_valor(i2c_oled_campo_t *campo, int32_t valor){
+    char nuevo[OLED_CAMPO_MAX];
+    uint8_t columnas[OLED_CAMPO_MAX * 8];
+    uint8_t viejo[8];
+    int inicio = -1;
+    int fin = -1;
+
+    memcpy(nuevo, campo->texto, campo->largo);
+    campo_formatear(campo, valor, nuevo);
+
+    for (uint8_t k = 0; k < campo->largo; k++) {
+        if (campo->valido && nuevo[k] == campo->texto[k]) {
+            continue; // Carácter igual, ni se rasteriza
+        }
+        i2c_oled_glifo(nuevo[k], campo->negado, &columnas[k * 8]);
+        if (campo->valido) {
+            i2c_oled_glifo(campo->texto[k], campo->negado, viejo);
+        }
+
+        for (int c = 0; c < 8; c++) {
+            int col = k * 8 + c;
+            if (campo->valido && columnas[col] == viejo[c]) {
+                continue;
+            }
+            if (inicio >= 0 && col - fin - 1 > CAMPO_HUECO) {
+                campo_enviar(campo, columnas, inicio, fin);
+                inicio = -1;
+            }
+            if (inicio < 0) {
+                inicio = col;
+            }
+            fin = col;
+        }
+    }
+    if (inicio >= 0) {
+        campo_enviar(campo, columnas, inicio, fin);
+    }
+
+    memcpy(campo->texto, nuevo, campo->largo);
+    campo->valido = true;
+}
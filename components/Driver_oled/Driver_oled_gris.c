@@ -0,0 +1,320 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: Driver_oled_gris.c
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: I2C, OLED 128x64
+* Notes                 :   Escala de grises de 4 niveles por dithering temporal.
+*                           Se guardan dos planos de 1 bit (bit alto y bit bajo del
+*                           nivel) y en cada subcuadro se manda al display un plano
+*                           distinto, de modo que el nivel n queda encendido en n de
+*                           los 3 subcuadros:
+*                               subcuadro 0: alto | bajo  (niveles 1, 2, 3)
+*                               subcuadro 1: alto         (niveles 2, 3)
+*                               subcuadro 2: alto & bajo  (nivel 3)
+*
+*******************************************************************************/
+#include <stdio.h>
+#include "Driver_oled.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+static const char *TAG = "oled_gris";
+
+// Palabras de 32 bits por plano
+#define GRIS_PALABRAS	(OLED_FB_BYTES / 4)
+// Ventana para medir la tasa lograda
+#define GRIS_VENTANA_US	1000000
+
+// Planos en formato de páginas, como palabras para que el kernel trabaje de 32 en 32 píxeles
+static uint32_t plano_alto[GRIS_PALABRAS];
+static uint32_t plano_bajo[GRIS_PALABRAS];
+static uint32_t plano_salida[GRIS_PALABRAS];
+
+static esp_timer_handle_t gris_timer = NULL;
+static TaskHandle_t gris_tarea_h = NULL;
+static volatile bool gris_sucio = false;
+static volatile bool gris_salir = false;
+static i2c_oled_gris_estado_t gris;
+
+
+
+/***************************************************************************
+* Function: i2c_oled_gris_planos
+* Preconditions: Ninguna.
+* Overview: Kernel de bits en paralelo que genera el plano de 1 bit de un subcuadro.
+*           Cada operación resuelve 32 píxeles a la vez.
+* Input: const uint32_t *alto, *bajo (planos de gris), uint8_t subcuadro (0..2),
+*        uint32_t *salida (plano resultante), size_t palabras (tamaño de los planos)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_gris_planos(const uint32_t *alto, const uint32_t *bajo, uint8_t subcuadro, uint32_t *salida, size_t palabras){
+    size_t i;
+
+    switch (subcuadro) {
+    case 0: // Niveles 1, 2 y 3
+        for (i = 0; i < palabras; i++) {
+            salida[i] = alto[i] | bajo[i];
+        }
+        break;
+    case 1: // Niveles 2 y 3
+        for (i = 0; i < palabras; i++) {
+            salida[i] = alto[i];
+        }
+        break;
+    default: // Solo nivel 3
+        for (i = 0; i < palabras; i++) {
+            salida[i] = alto[i] & bajo[i];
+        }
+        break;
+    }
+}
+
+
+
+/***************************************************************************
+* Function: gris_tick
+* Preconditions: gris_tarea_h creada.
+* Overview: Callback del timer periódico, avisa a la tarea que toca mandar un plano.
+* Input: void *arg (no se usa)
+* Output: Ninguno
+*****************************************************************************/
+static void gris_tick(void *arg){
+    xTaskNotifyGive(gris_tarea_h);
+}
+
+
+
+/***************************************************************************
+* Function: gris_tarea
+* Preconditions: i2c_oled_gris_iniciar
+* Overview: Manda un plano por cada aviso del timer y mide la tasa lograda.
+*           Si en una ventana la tasa cae por debajo del 90% de la pedida, el bus
+*           no alcanza y se regresa a 1 bit por píxel (solo niveles 2 y 3 encendidos),
+*           mandando el plano únicamente cuando hay cambios.
+* Input: void *arg (no se usa)
+* Output: Ninguno
+*****************************************************************************/
+static void gris_tarea(void *arg){
+    uint8_t subcuadro = 0;
+    uint32_t planos = 0;
+    uint64_t flush_total = 0;
+    int64_t inicio_ventana = esp_timer_get_time();
+
+    while (!gris_salir) {
+        uint32_t avisos = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (gris_salir) {
+            break;
+        }
+        if (avisos > 1) {
+            gris.perdidos += avisos - 1; // Ticks que llegaron mientras se mandaba el plano anterior
+        }
+
+        int64_t t0 = esp_timer_get_time();
+        if (gris.activo) {
+            i2c_oled_gris_planos(plano_alto, plano_bajo, subcuadro, plano_salida, GRIS_PALABRAS);
+            i2c_oled_flush((const uint8_t *)plano_salida);
+            subcuadro = (subcuadro + 1) % OLED_GRIS_SUBCUADROS;
+        } else if (gris_sucio) {
+            gris_sucio = false;
+            i2c_oled_flush((const uint8_t *)plano_alto);
+        } else {
+            continue;
+        }
+        int64_t t1 = esp_timer_get_time();
+        planos++;
+        flush_total += t1 - t0;
+
+        // Actualiza las métricas al cerrar cada ventana
+        if (t1 - inicio_ventana >= GRIS_VENTANA_US) {
+            gris.tasa_lograda = (uint32_t)(planos * 1000000ULL / (t1 - inicio_ventana));
+            gris.flush_us = (uint32_t)(flush_total / planos);
+            if (gris.activo) {
+                gris.margen_parpadeo = (float)gris.tasa_lograda / OLED_GRIS_SUBCUADROS / OLED_GRIS_UMBRAL_HZ;
+                if (gris.tasa_lograda * 10 < gris.tasa_objetivo * 9) {
+                    gris.activo = false;
+                    gris_sucio = true;
+                    ESP_LOGW(TAG, "%u planos/s de %u pedidos, se regresa a 1 bit por pixel",
+                             (unsigned)gris.tasa_lograda, (unsigned)gris.tasa_objetivo);
+                }
+            }
+            planos = 0;
+            flush_total = 0;
+            inicio_ventana = t1;
+        }
+    }
+
+    gris_tarea_h = NULL;
+    vTaskDelete(NULL);
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_gris_iniciar
+* Preconditions: i2c_init, i2c_oled_init
+* Overview: Arranca el modo de grises mandando planos a una tasa fija. Antes de
+*           arrancar mide cuánto tarda un plano en el bus; si no cabe en el periodo
+*           pedido, el modo arranca directamente en 1 bit por píxel.
+* Input: uint32_t planos_por_segundo (tasa de planos, el ciclo de gris es 1/3 de ella)
+* Output: esp_err_t (ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE si ya está corriendo,
+*         o el error del timer / ESP_ERR_NO_MEM)
+*****************************************************************************/
+esp_err_t i2c_oled_gris_iniciar(uint32_t planos_por_segundo){
+    if (planos_por_segundo == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (gris_tarea_h != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    uint64_t periodo_us = 1000000ULL / planos_por_segundo;
+
+    // Mide un plano completo en el bus
+    int64_t t0 = esp_timer_get_time();
+    i2c_oled_flush((const uint8_t *)plano_alto);
+    uint32_t flush_us = (uint32_t)(esp_timer_get_time() - t0);
+
+    memset(&gris, 0, sizeof(gris));
+    gris.tasa_objetivo = planos_por_segundo;
+    gris.flush_us = flush_us;
+    gris.margen_parpadeo = flush_us ? 1000000.0f / flush_us / OLED_GRIS_SUBCUADROS / OLED_GRIS_UMBRAL_HZ : 0;
+    gris.activo = flush_us < periodo_us;
+    if (!gris.activo) {
+        ESP_LOGW(TAG, "Un plano tarda %u us y el periodo es %u us, se usa 1 bit por pixel",
+                 (unsigned)flush_us, (unsigned)periodo_us);
+    }
+    gris_sucio = true;
+    gris_salir = false;
+
+    if (xTaskCreate(gris_tarea, "oled_gris", 2048, NULL, 5, &gris_tarea_h) != pdPASS) {
+        gris_tarea_h = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_timer_create_args_t args = {
+        .callback = gris_tick,
+        .name = "oled_gris",
+    };
+    esp_err_t err = esp_timer_create(&args, &gris_timer);
+    if (err == ESP_OK) {
+        err = esp_timer_start_periodic(gris_timer, periodo_us);
+    }
+    if (err != ESP_OK) {
+        i2c_oled_gris_detener();
+    }
+    return err;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_gris_detener
+* Preconditions: Ninguna.
+* Overview: Detiene el timer y espera a que la tarea termine el plano en curso.
+*           El contenido de los planos se conserva.
+* Input: Ninguno
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_gris_detener(){
+    if (gris_timer != NULL) {
+        esp_timer_stop(gris_timer);
+        esp_timer_delete(gris_timer);
+        gris_timer = NULL;
+    }
+    if (gris_tarea_h != NULL) {
+        gris_salir = true;
+        xTaskNotifyGive(gris_tarea_h);
+        while (gris_tarea_h != NULL) {
+            vTaskDelay(1);
+        }
+    }
+    gris.activo = false;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_gris_limpiar
+* Preconditions: Ninguna.
+* Overview: Borra los dos planos de gris.
+* Input: Ninguno
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_gris_limpiar(){
+    memset(plano_alto, 0, sizeof(plano_alto));
+    memset(plano_bajo, 0, sizeof(plano_bajo));
+    gris_sucio = true;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_gris_pixel
+* Preconditions: Ninguna.
+* Overview: Coloca un píxel con nivel de gris en los planos. El cambio se ve en el
+*           siguiente subcuadro.
+* Input: uint8_t x (columna), uint8_t y (fila en píxeles), uint8_t nivel (0 apagado .. 3 encendido)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_gris_pixel(uint8_t x, uint8_t y, uint8_t nivel){
+    if (x >= Ancho || y >= Alto) {
+        return;
+    }
+    uint8_t *alto = (uint8_t *)plano_alto;
+    uint8_t *bajo = (uint8_t *)plano_bajo;
+    int i = (y / 8) * Ancho + x;
+    uint8_t bit = 1 << (y % 8);
+
+    if (nivel & 0x02) {
+        alto[i] |= bit;
+    } else {
+        alto[i] &= ~bit;
+    }
+    if (nivel & 0x01) {
+        bajo[i] |= bit;
+    } else {
+        bajo[i] &= ~bit;
+    }
+    gris_sucio = true;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_gris_blit
+* Preconditions: Ninguna.
+* Overview: Copia un bloque de columnas de 2 bits (por ejemplo un icono o un carácter
+*           suavizado) en una página. Cada columna se da como un byte del plano alto y
+*           un byte del plano bajo, igual que los arreglos de caracteres.h.
+* Input: uint8_t y (página), uint8_t x (columna), const uint8_t *alto, *bajo (columnas),
+*        uint8_t ancho (número de columnas)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_gris_blit(uint8_t y, uint8_t x, const uint8_t *alto, const uint8_t *bajo, uint8_t ancho){
+    if (y > 7 || x >= Ancho) {
+        return;
+    }
+    if (ancho > Ancho - x) {
+        ancho = Ancho - x; // Recorta lo que sale de la pantalla
+    }
+    memcpy((uint8_t *)plano_alto + y * Ancho + x, alto, ancho);
+    memcpy((uint8_t *)plano_bajo + y * Ancho + x, bajo, ancho);
+    gris_sucio = true;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_gris_estado
+* Preconditions: Ninguna.
+* Overview: Copia las métricas del modo de grises: tasa de planos lograda, tiempo
+*           de un plano en el bus, planos perdidos y margen de parpadeo.
+* Input: i2c_oled_gris_estado_t *estado (destino)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_gris_estado(i2c_oled_gris_estado_t *estado){
+    *estado = gris;
+}
@@ -0,0 +1,358 @@
+/*******************************************************************************
+* Title                 :   TODO: OLED
+* Filename              :   TODO: Driver_oled_lista.c
+* Author                :   Kevin Rivera
+* Origin Date           :   13/06/2024
+* Version               :   17.9.1
+* Compiler              :   TODO: VISUAL STUDIO CODE
+* Target                :   TODO: I2C, OLED 128x64
+* Notes                 :   Listas de dibujo: una pantalla se graba una vez como una
+*                           secuencia binaria de operaciones y se reproduce con un
+*                           intérprete sobre un framebuffer o directo al bus.
+*
+*                           Formato (todos los campos son de 1 byte):
+*                               'O' 'D' version             cabecera
+*                               0x01 patron                 llena toda la pantalla
+*                               0x02 y x n c1..cn           texto en la página y
+*                               0x03 y x n c1..cn           texto con píxeles invertidos
+*                               0x04 y x ancho pags datos   bloque de pags páginas, ancho*pags bytes
+*                               0x05 y x ancho patron       llena columnas de una página
+*                               0x06 x y largo              línea horizontal (solo framebuffer)
+*                               0x07 x y largo              línea vertical (solo framebuffer)
+*                               0x00                        fin de la lista
+*
+*******************************************************************************/
+#include <stdio.h>
+#include "Driver_oled.h"
+
+
+
+/***************************************************************************
+* Function: lista_pos
+* Preconditions: i2c_oled_cmd_n
+* Overview: Coloca el cursor en (y, x) con una sola transacción.
+* Input: uint8_t y (página), uint8_t x (columna)
+* Output: Ninguno
+*****************************************************************************/
+static void lista_pos(uint8_t y, uint8_t x){
+    uint8_t pos[] = { 0x00 + (0x0F & x), 0x10 + (0x0F & (x >> 4)), 0xB0 + y };
+    i2c_oled_cmd_n(pos, sizeof(pos));
+}
+
+
+
+/***************************************************************************
+* Function: lista_columnas
+* Preconditions: lista_pos, i2c_oled_datos
+* Overview: Pone columnas en la página y a partir de x, en el framebuffer si hay
+*           uno o directo al display si fb es NULL.
+* Input: uint8_t *fb, uint8_t y, uint8_t x, const uint8_t *datos, uint8_t ancho (ya recortado)
+* Output: Ninguno
+*****************************************************************************/
+static void lista_columnas(uint8_t *fb, uint8_t y, uint8_t x, const uint8_t *datos, uint8_t ancho){
+    if (fb) {
+        memcpy(fb + y * Ancho + x, datos, ancho);
+    } else {
+        lista_pos(y, x);
+        i2c_oled_datos(datos, ancho);
+    }
+}
+
+
+
+/***************************************************************************
+* Function: lista_reproducir
+* Preconditions: i2c_init, i2c_oled_init si fb es NULL
+* Overview: Intérprete de la lista. Valida la cabecera y cada operación contra el
+*           tamaño de la lista antes de ejecutarla; todo lo que sale de la pantalla
+*           se recorta.
+* Input: const uint8_t *lista, size_t len, uint8_t *fb (OLED_FB_BYTES bytes o NULL para el bus)
+* Output: esp_err_t (ESP_OK, ESP_ERR_INVALID_VERSION, ESP_ERR_INVALID_SIZE si la lista está
+*         truncada, ESP_ERR_INVALID_ARG si hay una operación desconocida,
+*         ESP_ERR_NOT_SUPPORTED si hay líneas y fb es NULL)
+*****************************************************************************/
+static esp_err_t lista_reproducir(const uint8_t *lista, size_t len, uint8_t *fb){
+    const uint8_t *p = lista;
+    const uint8_t *fin = lista + len;
+    uint8_t columnas[Ancho];
+
+    if (len < 3 || p[0] != 'O' || p[1] != 'D' || p[2] != OLED_DL_VERSION) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    p += 3;
+
+// Verifica que queden al menos n bytes en la lista
+#define LISTA_QUEDAN(n) do { if ((size_t)(fin - p) < (size_t)(n)) return ESP_ERR_INVALID_SIZE; } while (0)
+
+    while (1) {
+        LISTA_QUEDAN(1);
+        uint8_t op = *p++;
+
+        switch (op) {
+        case OLED_DL_OP_FIN:
+            return ESP_OK;
+
+        case OLED_DL_OP_LIMPIAR: {
+            LISTA_QUEDAN(1);
+            uint8_t patron = *p++;
+            if (fb) {
+                memset(fb, patron, OLED_FB_BYTES);
+            } else {
+                memset(columnas, patron, Ancho);
+                for (uint8_t y = 0; y < Alto / 8; y++) {
+                    lista_columnas(NULL, y, 0, columnas, Ancho);
+                }
+            }
+            break;
+        }
+
+        case OLED_DL_OP_TEXTO:
+        case OLED_DL_OP_TEXTO_N: {
+            LISTA_QUEDAN(3);
+            uint8_t y = p[0], x = p[1], n = p[2];
+            p += 3;
+            LISTA_QUEDAN(n);
+            const uint8_t *texto = p;
+            p += n;
+            if (y > 7 || x >= Ancho) {
+                break;
+            }
+            // Rasteriza solo los caracteres que se ven y los manda como un bloque
+            uint8_t caben = (Ancho - x + 7) / 8;
+            if (n > caben) {
+                n = caben;
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                i2c_oled_glifo(texto[i], op == OLED_DL_OP_TEXTO_N, columnas + i * 8);
+            }
+            if (n) {
+                uint8_t ancho = n * 8 > Ancho - x ? Ancho - x : n * 8;
+                lista_columnas(fb, y, x, columnas, ancho);
+            }
+            break;
+        }
+
+        case OLED_DL_OP_BLIT: {
+            LISTA_QUEDAN(4);
+            uint8_t y = p[0], x = p[1], ancho = p[2], pags = p[3];
+            p += 4;
+            LISTA_QUEDAN((size_t)ancho * pags);
+            const uint8_t *datos = p;
+            p += (size_t)ancho * pags;
+            if (x >= Ancho) {
+                break;
+            }
+            uint8_t visible = ancho > Ancho - x ? Ancho - x : ancho;
+            for (uint8_t k = 0; k < pags && y + k < Alto / 8; k++) {
+                lista_columnas(fb, y + k, x, datos + k * ancho, visible);
+            }
+            break;
+        }
+
+        case OLED_DL_OP_RELLENO: {
+            LISTA_QUEDAN(4);
+            uint8_t y = p[0], x = p[1], ancho = p[2], patron = p[3];
+            p += 4;
+            if (y > 7 || x >= Ancho) {
+                break;
+            }
+            if (ancho > Ancho - x) {
+                ancho = Ancho - x;
+            }
+            if (fb) {
+                memset(fb + y * Ancho + x, patron, ancho);
+            } else {
+                memset(columnas, patron, ancho);
+                lista_columnas(NULL, y, x, columnas, ancho);
+            }
+            break;
+        }
+
+        case OLED_DL_OP_LINEA_H:
+        case OLED_DL_OP_LINEA_V: {
+            LISTA_QUEDAN(3);
+            uint8_t x = p[0], y = p[1], largo = p[2];
+            p += 3;
+            // El display no se puede leer por I2C, sin framebuffer no hay cómo mezclar píxeles
+            if (!fb) {
+                return ESP_ERR_NOT_SUPPORTED;
+            }
+            for (uint8_t i = 0; i < largo; i++) {
+                uint8_t px = op == OLED_DL_OP_LINEA_H ? x + i : x;
+                uint8_t py = op == OLED_DL_OP_LINEA_V ? y + i : y;
+                if (px >= Ancho || py >= Alto) {
+                    break;
+                }
+                fb[(py / 8) * Ancho + px] |= 1 << (py % 8);
+            }
+            break;
+        }
+
+        default:
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+#undef LISTA_QUEDAN
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_fb
+* Preconditions: Ninguna.
+* Overview: Reproduce una lista de dibujo sobre un framebuffer en formato de páginas.
+*           Después se manda con i2c_oled_flush.
+* Input: const uint8_t *lista, size_t len, uint8_t *fb (OLED_FB_BYTES bytes)
+* Output: esp_err_t (ver lista_reproducir)
+*****************************************************************************/
+esp_err_t i2c_oled_lista_fb(const uint8_t *lista, size_t len, uint8_t *fb){
+    return lista_reproducir(lista, len, fb);
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_bus
+* Preconditions: i2c_init, i2c_oled_init
+* Overview: Reproduce una lista de dibujo directo al display, sin framebuffer.
+*           Cada operación cuesta una posición y un bloque de datos por página.
+* Input: const uint8_t *lista, size_t len
+* Output: esp_err_t (ver lista_reproducir)
+*****************************************************************************/
+esp_err_t i2c_oled_lista_bus(const uint8_t *lista, size_t len){
+    return lista_reproducir(lista, len, NULL);
+}
+
+
+
+/***************************************************************************
+* Function: lista_agregar
+* Preconditions: i2c_oled_lista_nueva
+* Overview: Agrega bytes a la lista que se está grabando. Si no caben la lista
+*           se marca como desbordada y ya no crece.
+* Input: i2c_oled_lista_t *lista, const uint8_t *datos, size_t n
+* Output: Ninguno
+*****************************************************************************/
+static void lista_agregar(i2c_oled_lista_t *lista, const uint8_t *datos, size_t n){
+    if (lista->desbordada || lista->len + n > lista->cap) {
+        lista->desbordada = true;
+        return;
+    }
+    memcpy(lista->buf + lista->len, datos, n);
+    lista->len += n;
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_nueva
+* Preconditions: Ninguna.
+* Overview: Empieza a grabar una lista de dibujo en un buffer del usuario.
+* Input: i2c_oled_lista_t *lista, uint8_t *buf, size_t cap (tamaño del buffer)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_lista_nueva(i2c_oled_lista_t *lista, uint8_t *buf, size_t cap){
+    const uint8_t cabecera[] = { OLED_DL_CABECERA };
+
+    lista->buf = buf;
+    lista->cap = cap;
+    lista->len = 0;
+    lista->desbordada = false;
+    lista_agregar(lista, cabecera, sizeof(cabecera));
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_limpiar
+* Preconditions: i2c_oled_lista_nueva
+* Overview: Graba una operación que llena toda la pantalla con un patrón.
+* Input: i2c_oled_lista_t *lista, uint8_t patron (0x00 borra)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_lista_limpiar(i2c_oled_lista_t *lista, uint8_t patron){
+    const uint8_t op[] = { OLED_DL_LIMPIAR(patron) };
+    lista_agregar(lista, op, sizeof(op));
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_texto
+* Preconditions: i2c_oled_lista_nueva
+* Overview: Graba un texto en la página y, columna x. Sin salto de línea, se
+*           recorta en el borde derecho.
+* Input: i2c_oled_lista_t *lista, const char *string, uint8_t y, uint8_t x,
+*        bool negado (píxeles invertidos como i2c_oled_string_N)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_lista_texto(i2c_oled_lista_t *lista, const char *string, uint8_t y, uint8_t x, bool negado){
+    size_t n = strlen(string);
+    if (n > 255) {
+        n = 255;
+    }
+    const uint8_t op[] = { negado ? OLED_DL_OP_TEXTO_N : OLED_DL_OP_TEXTO, y, x, (uint8_t)n };
+    lista_agregar(lista, op, sizeof(op));
+    lista_agregar(lista, (const uint8_t *)string, n);
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_blit
+* Preconditions: i2c_oled_lista_nueva
+* Overview: Graba un bloque de columnas (icono o imagen) de una o varias páginas,
+*           con los datos página por página, igual que pila o wifi_1/wifi_2.
+* Input: i2c_oled_lista_t *lista, uint8_t y, uint8_t x, uint8_t ancho, uint8_t pags,
+*        const uint8_t *datos (ancho*pags bytes)
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_lista_blit(i2c_oled_lista_t *lista, uint8_t y, uint8_t x, uint8_t ancho, uint8_t pags, const uint8_t *datos){
+    const uint8_t op[] = { OLED_DL_BLIT(y, x, ancho, pags) };
+    lista_agregar(lista, op, sizeof(op));
+    lista_agregar(lista, datos, (size_t)ancho * pags);
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_relleno
+* Preconditions: i2c_oled_lista_nueva
+* Overview: Graba un relleno de columnas en una página (barras, fondos de banner).
+* Input: i2c_oled_lista_t *lista, uint8_t y, uint8_t x, uint8_t ancho, uint8_t patron
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_lista_relleno(i2c_oled_lista_t *lista, uint8_t y, uint8_t x, uint8_t ancho, uint8_t patron){
+    const uint8_t op[] = { OLED_DL_RELLENO(y, x, ancho, patron) };
+    lista_agregar(lista, op, sizeof(op));
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_linea
+* Preconditions: i2c_oled_lista_nueva
+* Overview: Graba una línea horizontal o vertical en coordenadas de píxel.
+*           Solo se puede reproducir sobre un framebuffer.
+* Input: i2c_oled_lista_t *lista, uint8_t x, uint8_t y, uint8_t largo, bool vertical
+* Output: Ninguno
+*****************************************************************************/
+void i2c_oled_lista_linea(i2c_oled_lista_t *lista, uint8_t x, uint8_t y, uint8_t largo, bool vertical){
+    const uint8_t op[] = { vertical ? OLED_DL_OP_LINEA_V : OLED_DL_OP_LINEA_H, x, y, largo };
+    lista_agregar(lista, op, sizeof(op));
+}
+
+
+
+/***************************************************************************
+* Function: i2c_oled_lista_cerrar
+* Preconditions: i2c_oled_lista_nueva
+* Overview: Termina la grabación agregando la marca de fin.
+* Input: i2c_oled_lista_t *lista
+* Output: esp_err_t (ESP_OK, o ESP_ERR_NO_MEM si la lista no cupo en el buffer)
+*****************************************************************************/
+esp_err_t i2c_oled_lista_cerrar(i2c_oled_lista_t *lista){
+    const uint8_t op[] = { OLED_DL_FIN };
+    lista_agregar(lista, op, sizeof(op));
+    return lista->desbordada ? ESP_ERR_NO_MEM : ESP_OK;
+}
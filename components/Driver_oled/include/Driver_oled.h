@@ -17,11 +17,14 @@
 #include <unistd.h>
 #include <esp_log.h>
 #include <string.h>
+#include <stdbool.h>
 #include <math.h>
 
 // Tamaño del display
 #define Alto	64
 #define Ancho	128
+// Tamaño en bytes de un framebuffer de 1 bit por píxel (formato de páginas)
+#define OLED_FB_BYTES	(Ancho * Alto / 8)
 // Estructura para manejar el display con su puerto, pines y direción
 typedef struct {
 	i2c_port_t i2c_port;
@@ -45,6 +48,15 @@ void i2c_oled_init();
 // Función para mandar un dato en forma de bytes
 void i2c_oled_dato(uint8_t data);
 
+// Función para mandar varios bytes de comando en una sola transacción
+void i2c_oled_cmd_n(const uint8_t *dato, size_t len);
+
+// Función para mandar un bloque de datos en una sola transacción
+void i2c_oled_datos(const uint8_t *data, size_t len);
+
+// Función para mandar un framebuffer completo (OLED_FB_BYTES bytes en formato de páginas)
+void i2c_oled_flush(const uint8_t *fb);
+
 // Función para colocar el cursor en la posición (x, y)
 void i2c_oled_pos(uint8_t y, uint8_t x);
 
@@ -57,6 +69,9 @@ void i2c_oled_char(uint8_t caracter);
 // Función para imprimir un caracter negado
 void i2c_oled_char_n(uint8_t caracter);
 
+// Función para rasterizar un caracter a 8 columnas sin mandarlo
+void i2c_oled_glifo(uint8_t caracter, bool negado, uint8_t *col);
+
 // Funcionpara mandar una cadena de caracteres en la posición (x,y)
 void i2c_oled_string(char* string, uint8_t y, uint8_t x);
 
@@ -73,3 +88,132 @@ void i2c_oled_wifi(uint8_t y, uint8_t x);
 
 // Funcionpara mandar una cadena de caracteres en la posición (x,y), con los pixeles invertidos
 void i2c_oled_string_N(char* string, uint8_t y, uint8_t x);
+
+// ---------------------------------------------------------------------------
+// Escala de grises por dithering temporal (2 bits por píxel, 4 niveles)
+// ---------------------------------------------------------------------------
+
+// Subcuadros por ciclo de gris: el nivel n (0..3) se enciende en n de los 3 subcuadros
+#define OLED_GRIS_SUBCUADROS	3
+// Frecuencia mínima del ciclo completo para que el ojo no perciba parpadeo
+#define OLED_GRIS_UMBRAL_HZ		50
+
+// Estado medido del modo de grises
+typedef struct {
+	uint32_t tasa_objetivo;		// Planos por segundo solicitados
+	uint32_t tasa_lograda;		// Planos por segundo enviados en la última ventana
+	uint32_t flush_us;			// Duración promedio de un plano en el bus
+	uint32_t perdidos;			// Planos que no se alcanzaron a enviar a tiempo
+	float margen_parpadeo;		// (tasa_lograda / 3) / OLED_GRIS_UMBRAL_HZ, menor a 1 parpadea
+	bool activo;				// false si se regresó a 1 bit por píxel
+} i2c_oled_gris_estado_t;
+
+// Función para arrancar el modo de grises a una tasa fija de planos por segundo
+esp_err_t i2c_oled_gris_iniciar(uint32_t planos_por_segundo);
+
+// Función para detener el modo de grises
+void i2c_oled_gris_detener();
+
+// Función para borrar el framebuffer de grises
+void i2c_oled_gris_limpiar();
+
+// Función para colocar un píxel con nivel de gris 0..3 en (x, y)
+void i2c_oled_gris_pixel(uint8_t x, uint8_t y, uint8_t nivel);
+
+// Función para copiar columnas de 2 bits (plano alto y bajo) en la página y
+void i2c_oled_gris_blit(uint8_t y, uint8_t x, const uint8_t *alto, const uint8_t *bajo, uint8_t ancho);
+
+// Función para leer las métricas del modo de grises
+void i2c_oled_gris_estado(i2c_oled_gris_estado_t *estado);
+
+// Función que genera el plano de 1 bit de un subcuadro a partir de los dos planos de gris
+void i2c_oled_gris_planos(const uint32_t *alto, const uint32_t *bajo, uint8_t subcuadro, uint32_t *salida, size_t palabras);
+
+// ---------------------------------------------------------------------------
+// Campos numéricos con actualización por dígito
+// ---------------------------------------------------------------------------
+
+// Caracteres máximos de un campo (número y unidades), una página completa
+#define OLED_CAMPO_MAX	(Ancho / 8)
+
+// Alineación del número dentro del campo
+typedef enum {
+	OLED_CAMPO_DERECHA,
+	OLED_CAMPO_IZQUIERDA
+} i2c_oled_alineacion_t;
+
+// Estructura de un campo numérico, guarda lo que está en pantalla
+typedef struct {
+	uint8_t y;							// Página
+	uint8_t x;							// Columna
+	uint8_t ancho;						// Caracteres del número (signo y punto incluidos)
+	uint8_t decimales;					// Dígitos después del punto
+	uint8_t largo;						// Caracteres totales con unidades
+	i2c_oled_alineacion_t alineacion;
+	bool negado;						// Píxeles invertidos
+	bool valido;						// false si hay que redibujar todo
+	char texto[OLED_CAMPO_MAX];			// Texto que está en pantalla
+} i2c_oled_campo_t;
+
+// Función para configurar un campo numérico en la página y, columna x
+void i2c_oled_campo_init(i2c_oled_campo_t *campo, uint8_t y, uint8_t x, uint8_t ancho, uint8_t decimales,
+                         i2c_oled_alineacion_t alineacion, const char *unidades, bool negado);
+
+// Función para forzar que el campo se redibuje completo en la siguiente actualización
+void i2c_oled_campo_invalidar(i2c_oled_campo_t *campo);
+
+// Función para mostrar un valor en punto fijo, solo manda las columnas que cambiaron
+void i2c_oled_campo_valor(i2c_oled_campo_t *campo, int32_t valor);
+
+// ---------------------------------------------------------------------------
+// Listas de dibujo (grabar una pantalla y reproducirla)
+// ---------------------------------------------------------------------------
+
+// Versión del formato binario, va en la cabecera de cada lista
+#define OLED_DL_VERSION		1
+
+// Códigos de operación
+#define OLED_DL_OP_FIN		0x00
+#define OLED_DL_OP_LIMPIAR	0x01
+#define OLED_DL_OP_TEXTO	0x02
+#define OLED_DL_OP_TEXTO_N	0x03
+#define OLED_DL_OP_BLIT		0x04
+#define OLED_DL_OP_RELLENO	0x05
+#define OLED_DL_OP_LINEA_H	0x06
+#define OLED_DL_OP_LINEA_V	0x07
+
+// Macros para escribir listas constantes en flash, por ejemplo:
+// static const uint8_t menu[] = { OLED_DL_CABECERA, OLED_DL_LIMPIAR(0x00),
+//                                 OLED_DL_TEXTO(0, 0, 4), 'M', 'e', 'n', 'u', OLED_DL_FIN };
+#define OLED_DL_CABECERA					'O', 'D', OLED_DL_VERSION
+#define OLED_DL_FIN							OLED_DL_OP_FIN
+#define OLED_DL_LIMPIAR(patron)				OLED_DL_OP_LIMPIAR, (patron)
+#define OLED_DL_TEXTO(y, x, n)				OLED_DL_OP_TEXTO, (y), (x), (n)
+#define OLED_DL_TEXTO_N(y, x, n)			OLED_DL_OP_TEXTO_N, (y), (x), (n)
+#define OLED_DL_BLIT(y, x, ancho, pags)		OLED_DL_OP_BLIT, (y), (x), (ancho), (pags)
+#define OLED_DL_RELLENO(y, x, ancho, patron)	OLED_DL_OP_RELLENO, (y), (x), (ancho), (patron)
+#define OLED_DL_LINEA_H(x, y, largo)		OLED_DL_OP_LINEA_H, (x), (y), (largo)
+#define OLED_DL_LINEA_V(x, y, largo)		OLED_DL_OP_LINEA_V, (x), (y), (largo)
+
+// Estructura para grabar una lista en un buffer
+typedef struct {
+	uint8_t *buf;
+	size_t cap;
+	size_t len;
+	bool desbordada;	// true si algo no cupo en el buffer
+} i2c_oled_lista_t;
+
+// Función para reproducir una lista sobre un framebuffer (OLED_FB_BYTES bytes)
+esp_err_t i2c_oled_lista_fb(const uint8_t *lista, size_t len, uint8_t *fb);
+
+// Función para reproducir una lista directo al display
+esp_err_t i2c_oled_lista_bus(const uint8_t *lista, size_t len);
+
+// Funciones para grabar una lista
+void i2c_oled_lista_nueva(i2c_oled_lista_t *lista, uint8_t *buf, size_t cap);
+void i2c_oled_lista_limpiar(i2c_oled_lista_t *lista, uint8_t patron);
+void i2c_oled_lista_texto(i2c_oled_lista_t *lista, const char *string, uint8_t y, uint8_t x, bool negado);
+void i2c_oled_lista_blit(i2c_oled_lista_t *lista, uint8_t y, uint8_t x, uint8_t ancho, uint8_t pags, const uint8_t *datos);
+void i2c_oled_lista_relleno(i2c_oled_lista_t *lista, uint8_t y, uint8_t x, uint8_t ancho, uint8_t patron);
+void i2c_oled_lista_linea(i2c_oled_lista_t *lista, uint8_t x, uint8_t y, uint8_t largo, bool vertical);
+esp_err_t i2c_oled_lista_cerrar(i2c_oled_lista_t *lista);